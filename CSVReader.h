@@ -0,0 +1,1223 @@
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <map>
+#include <regex>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <limits>
+#include <chrono>
+#include <ctime>
+#include <cerrno>
+#include <set>
+#include <string_view>
+
+class CSVReader {
+public:
+    struct CsvRow {
+        std::map<std::string, std::string> fields; // columns which are read or modified by a processing step
+        std::vector<std::string_view> raw; // untouched columns, byte ranges into mInputBuffer
+    };
+
+    CSVReader() = default;
+
+    // Rows hold string_views into mInputBuffer, a copied or moved reader would leave them pointing at the old buffer
+    CSVReader(const CSVReader &) = delete;
+    CSVReader &operator=(const CSVReader &) = delete;
+    CSVReader(CSVReader &&) = delete;
+    CSVReader &operator=(CSVReader &&) = delete;
+
+private:
+    std::string exePath;
+    std::string settingsFilePath;
+
+    std::vector<std::string> mHeadings;
+
+    std::vector<CsvRow> mCsvData;
+
+    // Whole input file, only kept when columns are projected so raw cells can point into it
+    std::string mInputBuffer;
+    std::set<std::string> mProjectedColumns;
+    std::unordered_map<std::string, size_t> mRawColumnSlots; // heading -> index into CsvRow::raw
+
+    // Running totals for one numeric column within a group
+    struct MeasureAggregate {
+        double sum = 0;
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        size_t count = 0;
+    };
+
+    struct GroupAggregate {
+        std::vector<std::string> keys;
+        size_t firstRow = 0; // used to keep the summary in the same order as the (sorted) data
+        std::vector<MeasureAggregate> measures;
+    };
+
+    struct AggregateSettings {
+        std::vector<std::pair<std::string, bool> > groupBy; // heading, group by month of a timestamp
+        std::vector<std::pair<std::string, std::vector<std::string> > > measures; // heading, operations
+    };
+
+    std::vector<std::string> mSummaryHeadings;
+    std::vector<std::vector<std::string> > mSummaryRows;
+
+    std::vector<std::string> splitLine(const std::string &line, char delimiter) {
+        std::vector<std::string> tokens;
+        std::string token;
+        std::stringstream tokenStream(line);
+
+        while (std::getline(tokenStream, token, delimiter)) {
+            tokens.push_back(token);
+        }
+
+        return tokens;
+    }
+
+public:
+    std::vector<std::string> splitLineRespectingQuotes(const std::string &line) {
+        std::vector<std::string> tokens;
+        std::string token;
+        bool insideQuotes = false;
+
+        for (size_t i = 0; i < line.length(); ++i) {
+            char currentChar = line[i];
+
+            if (currentChar == '"') {
+                insideQuotes = !insideQuotes; // Toggle the insideQuotes flag
+            } else if (currentChar == ',' && !insideQuotes) {
+                tokens.push_back(token);
+                token.clear();
+                continue;
+            }
+            token += currentChar;
+        }
+
+        tokens.push_back(token); // Add the last token
+
+        return tokens;
+    }
+
+    CSVReader *readCsv(const std::string &filePath) {
+        /**
+         * We handle internal commas by only splitting on commas which are outside of quotes, the cell keeps its original text
+         * (an earlier #!* placeholder was dropped, it turned any literal #!* in the data into a comma)
+         * We handle new lines inside quotes " \n " by joining the next line when the number of quotes in the current line is odd (should be matching open and closing quotes)
+         * When projected columns have been set, only those columns are split into strings, see readCsvProjected
+         */
+        std::ifstream file(filePath);
+
+        if (!file.is_open()) {
+            std::cerr << std::endl << "Unable to open file: " << filePath << std::endl;
+            return this;
+        }
+
+        readCsv(file);
+
+        file.close();
+        return this;
+    }
+
+    CSVReader *readCsv(std::istream &file) {
+        if (!mProjectedColumns.empty()) {
+            return readCsvProjected(file);
+        }
+
+        // Reading again replaces the previous file, rows from a projected read would point into the old buffer
+        mCsvData.clear();
+        mRawColumnSlots.clear();
+        mInputBuffer.clear();
+
+        std::string line;
+        std::getline(file, line);
+        mHeadings = splitLineRespectingQuotes(line);
+
+        while (std::getline(file, line)) {
+            if (line.empty() || line == "\r") continue; // Skip empty lines, including those of CRLF files
+
+            // Check if the line has an odd number of quotes
+            size_t quoteCount = std::count(line.begin(), line.end(), '"');
+            while (quoteCount % 2 != 0) {
+                std::string nextLine;
+                if (!std::getline(file, nextLine)) {
+                    break; // Exit loop if no more lines are available
+                }
+                line += "\n" + nextLine;
+                quoteCount += std::count(nextLine.begin(), nextLine.end(), '"');
+            }
+
+            auto tokens = splitLineRespectingQuotes(line);
+
+            CsvRow rowData;
+            for (size_t i = 0; i < tokens.size(); ++i) {
+                if (i < mHeadings.size()) {
+                    rowData.fields[mHeadings[i]] = tokens[i];
+                }
+            }
+            mCsvData.push_back(std::move(rowData));
+        }
+
+        return this;
+    }
+
+    // Same rules as splitLineRespectingQuotes, but returns ranges of the record instead of copies
+    static std::vector<std::string_view> splitRecord(std::string_view record) {
+        std::vector<std::string_view> tokens;
+        bool insideQuotes = false;
+        size_t tokenStart = 0;
+
+        for (size_t i = 0; i < record.length(); ++i) {
+            if (record[i] == '"') {
+                insideQuotes = !insideQuotes;
+            } else if (record[i] == ',' && !insideQuotes) {
+                tokens.push_back(record.substr(tokenStart, i - tokenStart));
+                tokenStart = i + 1;
+            }
+        }
+
+        tokens.push_back(record.substr(tokenStart)); // Add the last token
+
+        return tokens;
+    }
+
+    CSVReader *readCsvProjected(std::istream &file) {
+        /**
+         * The whole file is loaded into mInputBuffer, cells of columns which no processing step touches are kept as
+         * byte ranges into the buffer and written back out as is, only the projected columns are copied into strings
+         * Records are split following the same rules as readCsv (odd number of quotes joins the next line)
+         */
+        mCsvData.clear(); // Rows from a previous read point into the buffer which is about to be replaced
+
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        mInputBuffer = contents.str();
+
+        std::string_view buffer(mInputBuffer);
+        size_t pos = 0;
+
+        // Equivalent of std::getline over the buffer
+        auto nextLine = [&buffer, &pos](std::string_view &line) {
+            if (pos >= buffer.size()) {
+                return false;
+            }
+            size_t end = buffer.find('\n', pos);
+            if (end == std::string_view::npos) {
+                end = buffer.size();
+            }
+            line = buffer.substr(pos, end - pos);
+            pos = end + 1;
+            return true;
+        };
+
+        std::string_view line;
+        nextLine(line);
+        mHeadings.clear();
+        for (const auto &heading: splitRecord(line)) {
+            mHeadings.emplace_back(heading);
+        }
+
+        // Work out up front where each heading's cells go, -1 means the cell is copied into fields
+        mRawColumnSlots.clear();
+        std::vector<int> slots(mHeadings.size(), -1);
+        for (size_t i = 0; i < mHeadings.size(); ++i) {
+            if (mProjectedColumns.count(mHeadings[i]) == 0) {
+                auto inserted = mRawColumnSlots.emplace(mHeadings[i], mRawColumnSlots.size());
+                slots[i] = static_cast<int>(inserted.first->second);
+            }
+        }
+
+        while (nextLine(line)) {
+            if (line.empty() || line == "\r") continue; // Skip empty lines, including those of CRLF files
+
+            // Check if the line has an odd number of quotes
+            size_t recordStart = line.data() - buffer.data();
+            size_t recordEnd = recordStart + line.size();
+            size_t quoteCount = std::count(line.begin(), line.end(), '"');
+            while (quoteCount % 2 != 0) {
+                std::string_view nextLineView;
+                if (!nextLine(nextLineView)) {
+                    break; // Exit loop if no more lines are available
+                }
+                recordEnd = (nextLineView.data() - buffer.data()) + nextLineView.size();
+                quoteCount += std::count(nextLineView.begin(), nextLineView.end(), '"');
+            }
+
+            auto tokens = splitRecord(buffer.substr(recordStart, recordEnd - recordStart));
+
+            CsvRow rowData;
+            rowData.raw.resize(mRawColumnSlots.size());
+            for (size_t i = 0; i < tokens.size() && i < mHeadings.size(); ++i) {
+                if (slots[i] != -1) {
+                    rowData.raw[slots[i]] = tokens[i];
+                } else {
+                    rowData.fields[mHeadings[i]] = std::string(tokens[i]);
+                }
+            }
+            mCsvData.push_back(std::move(rowData));
+        }
+
+        return this;
+    }
+
+    // Columns listed here are materialised by readCsv, every other column is passed through untouched
+    void setProjectedColumns(const std::set<std::string> &columns) {
+        mProjectedColumns = columns;
+    }
+
+    std::set<std::string> getReferencedColumns() {
+        // Columns used directly by the processing steps, plus any column named in a settings.txt section
+        std::set<std::string> columns = {"*Description", "*DueDate", "DescDate", "DescDateTimeStamp"};
+        std::ifstream settingsFile = this->getSettingsFile();
+        std::string line;
+        bool insideSection = false;
+
+        while (std::getline(settingsFile, line)) {
+            if (line.empty()) {
+                continue; // Skip empty lines
+            }
+
+            if (!insideSection) {
+                insideSection = line == "replacements:" || line == "appendages:" || line == "sort order:";
+                continue;
+            }
+
+            if (line == "end:") {
+                insideSection = false;
+                continue;
+            }
+
+            size_t colonPos = line.find(':');
+            if (colonPos != std::string::npos) {
+                // Some sections trim the heading and some don't, so keep both
+                std::string heading = line.substr(0, colonPos);
+                columns.insert(heading);
+                trim(heading);
+                columns.insert(heading);
+            }
+        }
+
+        settingsFile.close();
+
+        AggregateSettings aggregateSettings = this->readAggregateSettings();
+        for (const auto &group: aggregateSettings.groupBy) {
+            columns.insert(group.first);
+        }
+        for (const auto &measure: aggregateSettings.measures) {
+            columns.insert(measure.first);
+        }
+
+        return columns;
+    }
+
+    [[nodiscard]] const std::vector<CsvRow> &getCsvData() const {
+        return mCsvData;
+    }
+
+    [[nodiscard]] const std::vector<std::string> &getHeadings() const {
+        return mHeadings;
+    }
+
+    CSVReader &writeCsv(const std::string &filePath) const {
+        // NOLINT(*-use-nodiscard)
+        // NOLINT(*-use-nodiscard)
+        std::ofstream file(filePath);
+
+        if (!file.is_open()) {
+            std::cerr << std::endl << "Unable to open file: " << filePath << std::endl;
+            return const_cast<CSVReader &>(*this);
+        }
+
+        writeCsv(file);
+
+        file.close();
+        return const_cast<CSVReader &>(*this);
+    }
+
+    CSVReader &writeCsv(std::ostream &file) const {
+        // Write the headings
+        for (size_t i = 0; i < mHeadings.size(); ++i) {
+            file << mHeadings[i];
+            if (i < mHeadings.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+
+
+        // Cells of columns which were never materialised are copied straight from the input buffer
+        std::vector<int> rawSlots(mHeadings.size(), -1);
+        for (size_t i = 0; i < mHeadings.size(); ++i) {
+            auto slot = mRawColumnSlots.find(mHeadings[i]);
+            if (slot != mRawColumnSlots.end()) {
+                rawSlots[i] = static_cast<int>(slot->second);
+            }
+        }
+
+        for (const auto &row: mCsvData) {
+            for (size_t i = 0; i < mHeadings.size(); ++i) {
+                if (rawSlots[i] != -1) {
+                    file << row.raw[rawSlots[i]];
+                    if (i < mHeadings.size() - 1) {
+                        file << ",";
+                    }
+                    continue;
+                }
+
+                auto it = row.fields.find(mHeadings[i]);
+                if (it != row.fields.end()) {
+                    file << it->second;
+                } else {
+                    file << ""; // Output an empty string if the cell data is missing
+                }
+                if (i < mHeadings.size() - 1) {
+                    file << ",";
+                }
+            }
+            file << "\n";
+        }
+
+        return const_cast<CSVReader &>(*this);
+    }
+
+    [[nodiscard]] int getHeadingIndexByName(const std::string &headingName) const {
+        for (size_t i = 0; i < mHeadings.size(); ++i) {
+            if (mHeadings[i] == headingName) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1; // Return -1 if the heading is not found
+    }
+
+    void addDescriptionDateColumn() {
+        this->mHeadings.push_back("DescDate");
+        auto descDateIdx = this->mHeadings.size() - 1;
+        this->mHeadings.push_back("DescDateTimeStamp");
+        auto timeStampIdx = this->mHeadings.size() - 1;
+        auto descriptionIdx = this->getHeadingIndexByName("*Description");
+
+        if (descriptionIdx == -1) {
+            std::cerr << std::endl << "Description column not found!" << std::endl;
+            return;
+        }
+
+        // Find the date in the format dd/mm/yy within the description, built once as it's costly to construct
+        std::regex dateRegex(R"((\d{2}/\d{2}/\d{2}))");
+
+        for (auto &row: this->mCsvData) {
+            std::string &description = row.fields["*Description"];
+            std::string date;
+            std::smatch match;
+
+            if (std::regex_search(description, match, dateRegex)) {
+                date = match.str(0); // Extract the date
+
+                // Remove the date from the description
+                description = std::regex_replace(description, dateRegex, "");
+            } else {
+                date = "N/A"; // No date found, use a default value
+                row.fields["DescDate"] = date;
+                row.fields["DescDateTimeStamp"] = "0"; // Use "0" to indicate an invalid timestamp
+                continue;
+            }
+
+            row.fields["DescDate"] = date; // Insert the extracted date into the new column
+
+            // Convert the date to a UTS timestamp
+            struct tm tm = {};
+            std::istringstream ss(date);
+            ss >> std::get_time(&tm, "%d/%m/%y"); // Parse the date string into tm struct
+
+            if (ss.fail()) {
+                std::cerr << std::endl << "Failed to parse date: " << date << std::endl;
+                row.fields["DescDateTimeStamp"] = "0"; // Use "0" to indicate an invalid timestamp
+                continue;
+            }
+
+            time_t timeStamp = mktime(&tm);
+            if (timeStamp == -1) {
+                std::cerr << std::endl << "Failed to convert date to timestamp: " << date << std::endl;
+                row.fields["DescDateTimeStamp"] = "0"; // Use "0" to indicate an invalid timestamp
+            } else {
+                row.fields["DescDateTimeStamp"] = std::to_string(timeStamp);
+            }
+        }
+    }
+
+    void doColumnReplacements() {
+        std::ifstream settingsFile = this->getSettingsFile();
+        std::map<std::string, std::map<std::string, std::string> > replacements;
+        std::string line;
+        bool replacementsSectionFound = false;
+
+        // Define the regex pattern as a string
+        std::string pattern = "\"([^\"]*)\"\\s*=\\s*\"([^\"]*)\"";
+        std::regex pairRegex(pattern);
+
+        // Read and process settings.txt
+        while (std::getline(settingsFile, line)) {
+            if (line.empty()) {
+                continue; // Skip empty lines
+            }
+
+            if (!replacementsSectionFound) {
+                if (line == "replacements:") {
+                    replacementsSectionFound = true;
+                }
+                continue; // Skip lines until "replacements:" is found
+            }
+
+            if (line == "end:") {
+                break;
+            }
+
+            // Split line into heading and replacements
+            size_t colonPos = line.find(':');
+            if (colonPos == std::string::npos) {
+                continue; // Skip lines without a colon
+            }
+
+            std::string heading = line.substr(0, colonPos);
+            std::string replacementsStr = line.substr(colonPos + 1);
+
+            auto headingIdx = this->getHeadingIndexByName(heading);
+            if (headingIdx == -1) {
+                std::cerr << "Warning: Heading '" << heading << "' not found in CSV. Skipping..." << std::endl;
+                continue;
+            }
+
+            // Parse the CSV list of replacements
+            std::map<std::string, std::string> replacementMap;
+            std::sregex_iterator iter(replacementsStr.begin(), replacementsStr.end(), pairRegex);
+            std::sregex_iterator end;
+
+            while (iter != end) {
+                std::string from = (*iter)[1].str();
+                std::string to = (*iter)[2].str();
+                replacementMap[from] = to;
+                ++iter;
+            }
+
+            replacements[heading] = replacementMap;
+        }
+
+        settingsFile.close();
+
+        // Process each row of the CSV data
+        for (auto &row: this->mCsvData) {
+            for (const auto &replacement: replacements) {
+                const std::string &heading = replacement.first;
+                const auto &replacementMap = replacement.second;
+
+                auto headingIdx = this->getHeadingIndexByName(heading);
+                if (headingIdx == -1) {
+                    std::cerr << "Warning: Heading '" << heading << "' not found in CSV. Skipping..." << std::endl;
+                    continue;
+                }
+
+                std::string &cellData = row.fields[heading];
+                for (const auto &pair: replacementMap) {
+                    const std::string &from = pair.first;
+                    const std::string &to = pair.second;
+                    size_t pos = 0;
+
+                    // Perform all occurrences of the replacement
+                    while ((pos = cellData.find(from, pos)) != std::string::npos) {
+                        cellData.replace(pos, from.length(), to);
+                        pos += to.length(); // Move past the replacement
+                    }
+                }
+            }
+        }
+    }
+
+
+    void applySorting() {
+        std::ifstream settingsFile = this->getSettingsFile();
+        std::vector<std::pair<std::string, std::string> > sortOrder;
+        std::string line;
+        bool sortOrderSectionFound = false;
+
+        // Read and process settings.txt until "sort order:" is found
+        while (std::getline(settingsFile, line)) {
+            if (line.empty()) {
+                continue; // Skip empty lines
+            }
+
+            if (!sortOrderSectionFound) {
+                if (line == "sort order:") {
+                    sortOrderSectionFound = true;
+                }
+                continue; // Skip lines until "sort order:" is found
+            }
+
+            if (line == "end:") {
+                break;
+            }
+
+            // Parse each line to extract the heading and order (asc/desc)
+            size_t colonPos = line.find(':');
+            if (colonPos != std::string::npos) {
+                std::string heading = line.substr(0, colonPos);
+                std::string order = line.substr(colonPos + 1);
+                trim(heading); // Remove extra spaces around heading
+                trim(order); // Remove extra spaces around order
+                sortOrder.emplace_back(heading, order);
+            }
+        }
+
+        settingsFile.close();
+
+        if (sortOrder.empty()) {
+            std::cerr << std::endl << "No sort order specified in settings.txt" << std::endl;
+            return;
+        }
+
+        // Sort the CSV data based on the sortOrder
+        // Work backwards through the vector to ensure the least significant sort order item is sorted first
+
+        for (auto it = sortOrder.rbegin(); it != sortOrder.rend(); ++it) {
+            const std::string &heading = it->first;
+            const std::string &order = it->second;
+
+            auto headingIdx = this->getHeadingIndexByName(heading);
+
+            if (headingIdx == -1) {
+                std::cerr << std::endl << "Warning: Heading '" << heading << "' not found in CSV. Skipping..." <<
+                        std::endl;
+                continue;
+            }
+
+            // Determine sort direction (ascending or descending)
+            bool ascending = (order == "asc");
+
+            // Lambda function to compare two rows based on the current heading
+            // Rows with fewer cells than headings are missing the column, treat the missing cell as empty
+            auto compare = [heading, ascending](const CsvRow &row1, const CsvRow &row2) {
+                static const std::string emptyCell;
+                auto it1 = row1.fields.find(heading);
+                auto it2 = row2.fields.find(heading);
+                const std::string &cell1 = it1 != row1.fields.end() ? it1->second : emptyCell;
+                const std::string &cell2 = it2 != row2.fields.end() ? it2->second : emptyCell;
+                if (ascending) {
+                    return cell1 < cell2;
+                } else {
+                    return cell1 > cell2;
+                }
+            };
+
+            // Use stable_sort instead of sort to maintain previous sort orders
+            std::stable_sort(mCsvData.begin(), mCsvData.end(), compare);
+            std::cout << "Sorting by " << heading << " (" << order << ")" << std::endl;
+        }
+    }
+
+    void trim(std::string &str) {
+        const char *whitespace = " \t\n\r\f\v";
+        str.erase(str.find_last_not_of(whitespace) + 1);
+        str.erase(0, str.find_first_not_of(whitespace));
+    }
+
+    void removeHeader(std::vector<std::string> &headings, const std::string &headerName) {
+        auto it = std::find(headings.begin(), headings.end(), headerName);
+        if (it != headings.end()) {
+            headings.erase(it);
+        } else {
+            std::cerr << "Header '" << headerName << "' not found!" << std::endl;
+        }
+    }
+
+    void applyDateToDescription() {
+        // Get the indices of the columns to be removed
+        auto descDateIdx = this->getHeadingIndexByName("DescDate");
+        auto timeStampIdx = this->getHeadingIndexByName("DescDateTimeStamp");
+        auto descriptionIdx = this->getHeadingIndexByName("*Description");
+
+        if (descriptionIdx == -1) {
+            std::cerr << std::endl << "Description column not found!" << std::endl;
+            return;
+        }
+
+        // Iterate through each row to modify *Description
+        for (auto &row: this->mCsvData) {
+            if (descDateIdx != -1) {
+                std::string descDate = row.fields["DescDate"];
+                std::string &description = row.fields["*Description"];
+
+                // Check if the description starts with a quote
+                if (!description.empty() && description.front() == '"') {
+                    // Insert DescDate after the opening quote
+                    description.insert(1, descDate + " ");
+                } else {
+                    // Prepend DescDate to *Description with a space
+                    description = descDate + " " + description;
+                }
+            }
+        }
+
+        // Remove the DescDate and DescDateTimeStamp columns
+        if (descDateIdx != -1) {
+            removeHeader(this->mHeadings, "DescDate");
+        }
+
+        if (timeStampIdx != -1) {
+            removeHeader(this->mHeadings, "DescDateTimeStamp");
+        }
+
+        // Also remove the columns from the data in each row
+        for (auto &row: this->mCsvData) {
+            if (descDateIdx != -1) {
+                row.fields.erase("DescDate");
+            }
+
+            if (timeStampIdx != -1) {
+                row.fields.erase("DescDateTimeStamp");
+            }
+        }
+    }
+
+
+    void updateDueDate() {
+        // Open settings.txt to find the "due date additional days:" line
+        std::ifstream settingsFile = this->getSettingsFile();
+
+        int daysToAdd = 0;
+        std::string line;
+
+        // Look for the "days to add to due date:" line
+        while (std::getline(settingsFile, line)) {
+            if (line.find("due date additional days:") != std::string::npos) {
+                // Extract the number after the colon
+                std::string value = line.substr(line.find(':') + 1);
+                daysToAdd = std::stoi(value);
+                break;
+            }
+        }
+
+        settingsFile.close();
+
+        if (daysToAdd == 0) {
+            std::cerr << std::endl << "No days to add specified or value is 0. Skipping due date update." << std::endl;
+            return;
+        }
+
+        // Update the "*DueDate" column
+        auto dueDateIdx = this->getHeadingIndexByName("*DueDate");
+        if (dueDateIdx == -1) {
+            std::cerr << std::endl << "DueDate column not found in CSV. Skipping..." << std::endl;
+            return;
+        }
+
+        for (auto &row: this->mCsvData) {
+            std::string dueDateStr = row.fields["*DueDate"];
+            std::tm dueDateTm = stringToDate(dueDateStr, "%d/%m/%Y");
+
+            // Add the specified number of days to the due date
+            std::chrono::system_clock::time_point dueDateTp = std::chrono::system_clock::from_time_t(
+                std::mktime(&dueDateTm));
+            dueDateTp += std::chrono::hours(24 * daysToAdd);
+
+            // Convert back to string and update the row
+            std::time_t newTime = std::chrono::system_clock::to_time_t(dueDateTp);
+            std::tm *newTm = std::localtime(&newTime);
+            row.fields["*DueDate"] = dateToString(*newTm, "%d/%m/%Y");
+        }
+
+        std::cout << "Due dates updated: added " << daysToAdd << " days." << std::endl;
+    }
+
+    // Helper function to convert string to std::tm
+    std::tm stringToDate(const std::string &dateStr, const std::string &format) {
+        std::tm tm = {};
+        std::istringstream ss(dateStr);
+        ss >> std::get_time(&tm, format.c_str());
+        return tm;
+    }
+
+    // Helper function to convert std::tm to string
+    std::string dateToString(const std::tm &tm, const std::string &format) {
+        std::ostringstream ss;
+        ss << std::put_time(&tm, format.c_str());
+        return ss.str();
+    }
+
+    void addAppendages() {
+        std::ifstream settingsFile = this->getSettingsFile();
+
+        std::map<std::string, std::vector<std::pair<std::string, std::string> > > appendagesMap;
+        std::string line;
+        bool appendagesSectionFound = false;
+
+        // Read and process settings.txt until "appendages:" is found
+        while (std::getline(settingsFile, line)) {
+            if (line.empty()) {
+                continue; // Skip empty lines
+            }
+
+            if (!appendagesSectionFound) {
+                if (line == "appendages:") {
+                    appendagesSectionFound = true;
+                }
+                continue; // Skip lines until "appendages:" is found
+            }
+
+            // End of appendages section
+            if (line == "end:") {
+                break;
+            }
+
+            // Parse the line into column name and key-value pairs
+            std::regex lineRegex(R"(([^:]+):(.+))");
+            std::smatch lineMatch;
+            if (std::regex_match(line, lineMatch, lineRegex)) {
+                std::string columnName = lineMatch[1].str();
+                std::string keyValues = lineMatch[2].str();
+
+                std::string pattern = "\"([^\"]+)\"\\s*=\\s*\"([^\"]+)\"";
+                std::regex pairRegex(pattern);
+
+                // Regex to match individual key-value pairs
+                auto pairBegin = std::sregex_iterator(keyValues.begin(), keyValues.end(), pairRegex);
+                auto pairEnd = std::sregex_iterator();
+
+                for (std::sregex_iterator i = pairBegin; i != pairEnd; ++i) {
+                    std::smatch match = *i;
+                    std::string key = match[1].str();
+                    std::string value = match[2].str();
+
+                    appendagesMap[columnName].emplace_back(key, value);
+                }
+            } else {
+                std::cerr << std::endl << "Invalid appendages line format: " << line << std::endl;
+            }
+        }
+
+        settingsFile.close();
+
+        // Process each row in the CSV data
+        for (auto &row: this->mCsvData) {
+            for (const auto &appendage: appendagesMap) {
+                const std::string &columnName = appendage.first;
+
+                // Check if the specified column exists and doesn't contain "Claim Type"
+                if (row.fields.find(columnName) != row.fields.end() && row.fields[columnName].find("Claim Type") == std::string::npos) {
+                    for (const auto &pair: appendage.second) {
+                        const std::string &key = pair.first;
+                        const std::string &value = pair.second;
+
+                        // If the column contains the key, append the value
+                        if (row.fields[columnName].find(key) != std::string::npos) {
+                            row.fields[columnName] += " " + value;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    AggregateSettings readAggregateSettings() {
+        std::ifstream settingsFile = this->getSettingsFile();
+        AggregateSettings settings;
+        std::string line;
+        bool aggregateSectionFound = false;
+
+        // Read and process settings.txt until "aggregate:" is found
+        while (std::getline(settingsFile, line)) {
+            if (line.empty()) {
+                continue; // Skip empty lines
+            }
+
+            if (!aggregateSectionFound) {
+                if (line == "aggregate:") {
+                    aggregateSectionFound = true;
+                }
+                continue; // Skip lines until "aggregate:" is found
+            }
+
+            if (line == "end:") {
+                break;
+            }
+
+            // "group by:" lists the key columns, every other line is a numeric column and its operations
+            size_t colonPos = line.find(':');
+            if (colonPos == std::string::npos) {
+                continue; // Skip lines without a colon
+            }
+
+            std::string heading = line.substr(0, colonPos);
+            std::vector<std::string> values = splitLine(line.substr(colonPos + 1), ',');
+            trim(heading);
+
+            for (auto &value: values) {
+                trim(value);
+            }
+
+            if (heading == "group by") {
+                for (auto &value: values) {
+                    bool byMonth = false;
+                    size_t monthPos = value.find("(month)");
+                    if (monthPos != std::string::npos) {
+                        value.erase(monthPos);
+                        trim(value);
+
+                        // Only DescDateTimeStamp holds timestamps, other columns are grouped on their value
+                        byMonth = value == "DescDateTimeStamp";
+                        if (!byMonth) {
+                            std::cerr << std::endl << "(month) is only supported on DescDateTimeStamp, grouping '"
+                                    << value << "' by its value instead" << std::endl;
+                        }
+                    }
+                    if (!value.empty()) {
+                        settings.groupBy.emplace_back(value, byMonth);
+                    }
+                }
+            } else {
+                std::vector<std::string> operations;
+                for (const auto &value: values) {
+                    if (value == "sum" || value == "count" || value == "min" || value == "max" || value == "avg") {
+                        operations.push_back(value);
+                    } else {
+                        std::cerr << std::endl << "Unknown aggregate operation '" << value << "' for " << heading
+                                << ". Skipping..." << std::endl;
+                    }
+                }
+                if (!operations.empty()) {
+                    settings.measures.emplace_back(heading, operations);
+                }
+            }
+        }
+
+        settingsFile.close();
+        return settings;
+    }
+
+    // Helper function to read a cell as a number, ignoring quotes, currency symbols and thousands separators
+    static bool parseNumber(const std::string &cell, double &value) {
+        std::string cleaned;
+        for (char c: cell) {
+            if (c != '"' && c != '$' && c != ',' && c != ' ') {
+                cleaned += c;
+            }
+        }
+
+        if (cleaned.empty()) {
+            return false;
+        }
+
+        char *end = nullptr;
+        value = std::strtod(cleaned.c_str(), &end);
+        return end == cleaned.c_str() + cleaned.size();
+    }
+
+    // Helper function to convert a DescDateTimeStamp into a yyyy-mm bucket
+    static std::string timeStampToMonth(const std::string &timeStampStr) {
+        static std::mutex localtimeMutex; // std::localtime shares a static buffer between threads
+        char *end = nullptr;
+        errno = 0;
+        std::time_t timeStamp = static_cast<std::time_t>(std::strtoll(timeStampStr.c_str(), &end, 10));
+
+        if (timeStampStr.empty() || *end != '\0' || errno == ERANGE || timeStamp == 0) {
+            return "N/A";
+        }
+
+        std::lock_guard<std::mutex> lock(localtimeMutex);
+        std::tm *tm = std::localtime(&timeStamp);
+        if (tm == nullptr) {
+            return "N/A"; // Out of the range localtime can represent
+        }
+
+        std::ostringstream ss;
+        ss << std::put_time(tm, "%Y-%m");
+        return ss.str();
+    }
+
+    void aggregate() {
+        /**
+         * Single pass hash based group by, the rows are split into one chunk per thread and each thread builds
+         * its own partial aggregates which are merged once all threads have finished
+         */
+        AggregateSettings settings = this->readAggregateSettings();
+        mSummaryHeadings.clear();
+        mSummaryRows.clear();
+
+        if (settings.groupBy.empty() || settings.measures.empty()) {
+            return; // Aggregation is optional, nothing to do unless both sections are present
+        }
+
+        for (const auto &group: settings.groupBy) {
+            if (this->getHeadingIndexByName(group.first) == -1) {
+                std::cerr << std::endl << "Aggregate column '" << group.first << "' not found in CSV. Skipping aggregation..."
+                        << std::endl;
+                return;
+            }
+        }
+
+        for (const auto &measure: settings.measures) {
+            if (this->getHeadingIndexByName(measure.first) == -1) {
+                std::cerr << std::endl << "Aggregate column '" << measure.first << "' not found in CSV. Skipping aggregation..."
+                        << std::endl;
+                return;
+            }
+        }
+
+        using PartialAggregates = std::unordered_map<std::string, GroupAggregate>;
+
+        auto aggregateRows = [this, &settings](size_t begin, size_t end, PartialAggregates &groups) {
+            std::unordered_map<std::string, std::string> monthCache; // timestamps repeat a lot, avoid the lock
+            const std::string emptyCell;
+            std::vector<std::string> keys(settings.groupBy.size());
+            std::string groupKey;
+
+            for (size_t rowIdx = begin; rowIdx < end; ++rowIdx) {
+                const auto &row = mCsvData[rowIdx];
+                groupKey.clear();
+
+                for (size_t i = 0; i < settings.groupBy.size(); ++i) {
+                    auto it = row.fields.find(settings.groupBy[i].first);
+                    const std::string &cell = it != row.fields.end() ? it->second : emptyCell;
+
+                    if (settings.groupBy[i].second) {
+                        auto cached = monthCache.find(cell);
+                        if (cached == monthCache.end()) {
+                            cached = monthCache.emplace(cell, timeStampToMonth(cell)).first;
+                        }
+                        keys[i] = cached->second;
+                    } else {
+                        keys[i] = cell;
+                    }
+
+                    groupKey += keys[i];
+                    groupKey += '\x1f'; // Unit separator, will not appear in the data
+                }
+
+                auto inserted = groups.try_emplace(groupKey);
+                GroupAggregate &group = inserted.first->second;
+                if (inserted.second) {
+                    group.keys = keys;
+                    group.firstRow = rowIdx;
+                    group.measures.resize(settings.measures.size());
+                }
+
+                for (size_t i = 0; i < settings.measures.size(); ++i) {
+                    auto it = row.fields.find(settings.measures[i].first);
+                    double value;
+                    if (it == row.fields.end() || !parseNumber(it->second, value)) {
+                        continue; // Non numeric cells are left out of the totals
+                    }
+
+                    MeasureAggregate &measure = group.measures[i];
+                    measure.sum += value;
+                    measure.min = std::min(measure.min, value);
+                    measure.max = std::max(measure.max, value);
+                    measure.count++;
+                }
+            }
+        };
+
+        // Small files are not worth the cost of starting threads
+        const size_t minRowsPerThread = 10000;
+        size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+        threadCount = std::max<size_t>(1, std::min(threadCount, mCsvData.size() / minRowsPerThread));
+
+        std::vector<PartialAggregates> partials(threadCount);
+        std::vector<std::thread> threads;
+        size_t chunkSize = (mCsvData.size() + threadCount - 1) / threadCount;
+
+        for (size_t t = 1; t < threadCount; ++t) {
+            size_t begin = std::min(t * chunkSize, mCsvData.size());
+            size_t end = std::min(begin + chunkSize, mCsvData.size());
+            threads.emplace_back(aggregateRows, begin, end, std::ref(partials[t]));
+        }
+        aggregateRows(0, std::min(chunkSize, mCsvData.size()), partials[0]);
+
+        for (auto &thread: threads) {
+            thread.join();
+        }
+
+        // Merge the partial aggregates into the first thread's results
+        PartialAggregates &groups = partials[0];
+        for (size_t t = 1; t < threadCount; ++t) {
+            for (auto &entry: partials[t]) {
+                auto inserted = groups.try_emplace(entry.first, std::move(entry.second));
+                if (inserted.second) {
+                    continue;
+                }
+
+                GroupAggregate &group = inserted.first->second;
+                group.firstRow = std::min(group.firstRow, entry.second.firstRow);
+                for (size_t i = 0; i < group.measures.size(); ++i) {
+                    const MeasureAggregate &other = entry.second.measures[i];
+                    group.measures[i].sum += other.sum;
+                    group.measures[i].min = std::min(group.measures[i].min, other.min);
+                    group.measures[i].max = std::max(group.measures[i].max, other.max);
+                    group.measures[i].count += other.count;
+                }
+            }
+        }
+
+        // Only the (small) list of groups is ordered, by the first row each group appeared in
+        std::vector<const GroupAggregate *> ordered;
+        ordered.reserve(groups.size());
+        for (const auto &entry: groups) {
+            ordered.push_back(&entry.second);
+        }
+        std::sort(ordered.begin(), ordered.end(), [](const GroupAggregate *a, const GroupAggregate *b) {
+            return a->firstRow < b->firstRow;
+        });
+
+        for (const auto &group: settings.groupBy) {
+            mSummaryHeadings.push_back(group.second ? group.first + " (month)" : group.first);
+        }
+        for (const auto &measure: settings.measures) {
+            for (const auto &operation: measure.second) {
+                mSummaryHeadings.push_back(measure.first + " " + operation);
+            }
+        }
+
+        for (const GroupAggregate *group: ordered) {
+            std::vector<std::string> summaryRow = group->keys;
+
+            for (size_t i = 0; i < settings.measures.size(); ++i) {
+                const MeasureAggregate &measure = group->measures[i];
+
+                for (const auto &operation: settings.measures[i].second) {
+                    std::ostringstream ss;
+                    ss << std::fixed << std::setprecision(2);
+
+                    if (operation == "count") {
+                        ss << measure.count;
+                    } else if (operation == "sum") {
+                        ss << measure.sum;
+                    } else if (measure.count > 0) {
+                        if (operation == "min") {
+                            ss << measure.min;
+                        } else if (operation == "max") {
+                            ss << measure.max;
+                        } else if (operation == "avg") {
+                            ss << measure.sum / static_cast<double>(measure.count);
+                        }
+                    }
+                    summaryRow.push_back(ss.str());
+                }
+            }
+
+            mSummaryRows.push_back(summaryRow);
+        }
+
+        std::cout << "Aggregated " << mCsvData.size() << " rows into " << mSummaryRows.size() << " groups using "
+                << threadCount << " thread(s)." << std::endl;
+    }
+
+    CSVReader &writeSummaryCsv(const std::string &filePath) const {
+        if (mSummaryHeadings.empty()) {
+            return const_cast<CSVReader &>(*this); // No aggregate section in settings.txt
+        }
+
+        std::ofstream file(filePath);
+
+        if (!file.is_open()) {
+            std::cerr << std::endl << "Unable to open file: " << filePath << std::endl;
+            return const_cast<CSVReader &>(*this);
+        }
+
+        writeSummaryCsv(file);
+
+        file.close();
+        return const_cast<CSVReader &>(*this);
+    }
+
+    CSVReader &writeSummaryCsv(std::ostream &file) const {
+        if (mSummaryHeadings.empty()) {
+            return const_cast<CSVReader &>(*this); // No aggregate section in settings.txt
+        }
+
+        for (size_t i = 0; i < mSummaryHeadings.size(); ++i) {
+            file << mSummaryHeadings[i];
+            if (i < mSummaryHeadings.size() - 1) {
+                file << ",";
+            }
+        }
+        file << "\n";
+
+        for (const auto &row: mSummaryRows) {
+            for (size_t i = 0; i < row.size(); ++i) {
+                file << row[i];
+                if (i < row.size() - 1) {
+                    file << ",";
+                }
+            }
+            file << "\n";
+        }
+
+        return const_cast<CSVReader &>(*this);
+    }
+
+    std::string getNewFileNamePostfix() {
+        std::ifstream settingsFile = this->getSettingsFile();
+        std::string line;
+        // Look for the "days to add to due date:" line
+        while (std::getline(settingsFile, line)) {
+            if (line.find("new file name postfix:") != std::string::npos) {
+                std::string value = line.substr(line.find(':') + 1);
+                settingsFile.close();
+                trim (value);
+                return value;
+            }
+        }
+
+        settingsFile.close();
+        return "_new";
+    }
+
+    // Read settings from a specific file instead of settings.txt next to the executable
+    void setSettingsFilePath(const std::string &settingsFilePath) {
+        this->settingsFilePath = settingsFilePath;
+    }
+
+    void setExePath(char * str) {
+        std::filesystem::path exePath = std::filesystem::absolute(str);
+        this->exePath =  exePath.parent_path().string();
+    }
+
+    [[nodiscard]] std::string getSettingsFilePath() const {
+        if (!this->settingsFilePath.empty()) {
+            return this->settingsFilePath;
+        }
+        return (std::filesystem::path(this->exePath) / "settings.txt").string();
+    }
+
+    std::ifstream getSettingsFile() const {
+        std::ifstream settingsFile(this->getSettingsFilePath());
+        return settingsFile;
+    };
+};
+
+
+inline void processInvoices(CSVReader &reader) {
+    // Add temporary columns explicity formatting data as dd/mm/yy and UTS to assist with sorting
+    reader.addDescriptionDateColumn();
+    reader.doColumnReplacements();
+    reader.applySorting();
+
+    // totals per group are worked out while DescDateTimeStamp is still available
+    reader.aggregate();
+
+    // note: Description may or may not be wrapped in speechmarks, depending on internal commas :|
+    reader.applyDateToDescription();
+
+    // all additional days to be added to due date
+    reader.updateDueDate();
+
+    // specific case is to add Claim Type if an item code exists
+    // but extended to a more general function which might be used on other columns
+    reader.addAppendages();
+}
+
+#endif //CSVREADER_H
@@ -0,0 +1,114 @@
+#ifndef READPATHCHECK_H
+#define READPATHCHECK_H
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <algorithm>
+
+#include "CSVReader.h"
+
+struct ReadPathResult {
+    bool match = true;
+    std::string mismatchIn; // "new file" or "summary"
+    size_t lineNumber = 0;
+    std::string referenceLine;
+    std::string projectedLine;
+    std::string outputs[2]; // reference, projected
+    double seconds[2] = {0, 0};
+};
+
+inline ReadPathResult compareReadPaths(const std::string &csv, const std::string &settingsFilePath) {
+    /**
+     * Runs the same bytes through read -> processInvoices -> write twice, once with every column materialised
+     * (the reference path) and once with projected columns, and checks the new file and summary match byte for byte
+     * Used by lisha --compare, the differential test and the fuzz target
+     */
+    ReadPathResult result;
+    std::string summaries[2];
+
+    // The processing steps report progress on std::cout / std::cerr, keep that out of the check's output
+    std::streambuf *coutBuffer = std::cout.rdbuf(nullptr);
+    std::streambuf *cerrBuffer = std::cerr.rdbuf(nullptr);
+    struct RestoreStreams {
+        std::streambuf *coutBuffer;
+        std::streambuf *cerrBuffer;
+
+        ~RestoreStreams() {
+            std::cout.rdbuf(coutBuffer);
+            std::cerr.rdbuf(cerrBuffer);
+        }
+    } restoreStreams{coutBuffer, cerrBuffer};
+
+    for (int projected = 0; projected < 2; ++projected) {
+        CSVReader reader;
+        reader.setSettingsFilePath(settingsFilePath);
+        if (projected) {
+            reader.setProjectedColumns(reader.getReferencedColumns());
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::istringstream input(csv);
+        reader.readCsv(input);
+        processInvoices(reader);
+
+        std::ostringstream output;
+        std::ostringstream summary;
+        reader.writeCsv(output);
+        reader.writeSummaryCsv(summary);
+        result.seconds[projected] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        result.outputs[projected] = output.str();
+        summaries[projected] = summary.str();
+    }
+
+    if (result.outputs[0] == result.outputs[1] && summaries[0] == summaries[1]) {
+        return result;
+    }
+
+    result.match = false;
+    result.mismatchIn = result.outputs[0] != result.outputs[1] ? "new file" : "summary";
+    const std::string &reference = result.outputs[0] != result.outputs[1] ? result.outputs[0] : summaries[0];
+    const std::string &projectedOutput = result.outputs[0] != result.outputs[1] ? result.outputs[1] : summaries[1];
+
+    // Report the first line which differs to make the mismatch easy to find
+    auto mismatch = std::mismatch(reference.begin(), reference.end(), projectedOutput.begin(), projectedOutput.end());
+    size_t offset = mismatch.first - reference.begin();
+    size_t lineStart = offset == 0 ? std::string::npos : reference.rfind('\n', offset - 1);
+    lineStart = lineStart == std::string::npos ? 0 : lineStart + 1;
+    result.lineNumber = std::count(reference.begin(), reference.begin() + lineStart, '\n') + 1;
+
+    auto lineAt = [lineStart](const std::string &str) {
+        return lineStart < str.size() ? str.substr(lineStart, str.find('\n', lineStart) - lineStart) : std::string();
+    };
+    result.referenceLine = lineAt(reference);
+    result.projectedLine = lineAt(projectedOutput);
+
+    return result;
+}
+
+inline void printReadPathResult(const std::string &name, size_t bytes, const ReadPathResult &result) {
+    double megabytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+
+    std::cout << std::endl << name << " (" << std::fixed << std::setprecision(2) << megabytes << " MB)" << std::endl;
+
+    const char *pathNames[2] = {"reference", "projected"};
+    for (int projected = 0; projected < 2; ++projected) {
+        std::cout << "  " << pathNames[projected] << ": " << std::setprecision(3) << result.seconds[projected] << "s, "
+                << std::setprecision(2) << (result.seconds[projected] > 0 ? megabytes / result.seconds[projected] : 0.0)
+                << " MB/s" << std::endl;
+    }
+
+    if (result.match) {
+        std::cout << "  outputs match" << std::endl;
+        return;
+    }
+
+    std::cout << "  MISMATCH in " << result.mismatchIn << " at line " << result.lineNumber << std::endl;
+    std::cout << "    reference: " << result.referenceLine << std::endl;
+    std::cout << "    projected: " << result.projectedLine << std::endl;
+}
+
+#endif //READPATHCHECK_H
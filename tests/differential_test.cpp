@@ -0,0 +1,257 @@
+#include <iostream>
+#include <cstdio>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "ReadPathCheck.h"
+
+/**
+ * Differential test for the read paths, every input is processed by the reference (everything materialised) and the
+ * projected path and the outputs must match byte for byte
+ * Generated inputs use a fixed seed so a failure can be reproduced, the regression inputs also check the expected
+ * output for bugs which were found this way (both paths could agree on a wrong answer)
+ */
+
+namespace {
+    const std::vector<std::string> baseHeadings = {
+        "*ContactName", "EmailAddress", "*InvoiceNumber", "*DueDate", "*Description", "*Quantity", "*UnitAmount",
+        "\"Addr, Line\""
+    };
+
+    std::string joinRow(const std::vector<std::string> &cells) {
+        std::string row;
+        for (size_t i = 0; i < cells.size(); ++i) {
+            row += cells[i];
+            if (i < cells.size() - 1) {
+                row += ",";
+            }
+        }
+        return row;
+    }
+
+    std::vector<std::string> headings(size_t extraColumns) {
+        std::vector<std::string> result = baseHeadings;
+        for (size_t i = 0; i < extraColumns; ++i) {
+            result.push_back("Extra" + std::to_string(i));
+        }
+        return result;
+    }
+
+    // A well formed invoice line, the extra columns are filled in by the caller
+    std::vector<std::string> invoiceRow(std::mt19937 &rng, size_t rowIdx) {
+        std::uniform_int_distribution<int> day(1, 28);
+        std::uniform_int_distribution<int> month(1, 12);
+        std::uniform_int_distribution<int> amount(1, 500);
+        const char *contacts[] = {"Alice", "\"Bob, Jr\"", "Carol", "\"Dee \"\"D\"\"\""};
+        const char *items[] = {"NF2F", "TRAN", "REPW", "01_661_0128_1_3"};
+
+        char dueDate[16];
+        char descDate[16];
+        std::snprintf(dueDate, sizeof(dueDate), "%02d/%02d/2024", day(rng), month(rng));
+        std::snprintf(descDate, sizeof(descDate), "%02d/%02d/24", day(rng), month(rng));
+
+        return {
+            contacts[rng() % 4], "x@example.com", "INV" + std::to_string(rowIdx), dueDate,
+            "\"" + std::string(items[rng() % 4]) + ", " + descDate + " delivered on \"",
+            std::to_string(rng() % 5 + 1), std::to_string(amount(rng)) + ".50", "\"1 Main St, Town\""
+        };
+    }
+
+    struct GeneratedInput {
+        std::string name;
+        std::function<std::string(std::mt19937 &, size_t)> cell; // extra column cell generator
+        size_t rows;
+        size_t extraColumns;
+        const char *newline;
+        double shortRowChance;
+    };
+
+    std::string generate(const GeneratedInput &input, std::mt19937 &rng) {
+        std::uniform_real_distribution<double> chance(0.0, 1.0);
+        std::vector<std::string> heading = headings(input.extraColumns);
+        std::string csv = joinRow(heading) + input.newline;
+
+        for (size_t rowIdx = 0; rowIdx < input.rows; ++rowIdx) {
+            std::vector<std::string> cells = invoiceRow(rng, rowIdx);
+            for (size_t i = 0; i < input.extraColumns; ++i) {
+                cells.push_back(input.cell(rng, i));
+            }
+            if (chance(rng) < input.shortRowChance) {
+                cells.resize(rng() % cells.size());
+            }
+            csv += joinRow(cells) + input.newline;
+        }
+
+        return csv;
+    }
+
+    std::string pick(std::mt19937 &rng, const std::vector<std::string> &options) {
+        return options[rng() % options.size()];
+    }
+
+    struct RegressionInput {
+        std::string name;
+        std::string csv;
+        std::vector<std::string> expectedInOutput;
+        std::vector<std::string> notExpectedInOutput;
+        size_t expectedLines; // header plus rows
+    };
+
+    std::vector<RegressionInput> regressionInputs() {
+        return {
+            {
+                // The #!* placeholder used to leak into quoted headings
+                "quoted heading with comma",
+                "*ContactName,*DueDate,*Description,\"Addr, Line\"\n"
+                "Alice,01/02/2024,\"NF2F, 03/01/24\",\"1 Main St, Town\"\n",
+                {"\"Addr, Line\"", "\"1 Main St, Town\""}, {"#!*"}, 2
+            },
+            {
+                // A literal #!* used to be turned into a comma on the way back out
+                "literal placeholder text",
+                "*ContactName,*DueDate,*Description,Notes\n"
+                "Alice,01/02/2024,\"has #!* lit, 03/01/24\",has #!* lit\n",
+                {"has #!* lit\n", "has #!* lit, "}, {"has , lit"}, 2
+            },
+            {
+                // Blank lines of CRLF files ("\r") used to be read as rows
+                "blank CRLF lines",
+                "*ContactName,*DueDate,*Description\r\n"
+                "Alice,01/02/2024,NF2F 03/01/24\r\n"
+                "\r\n"
+                "\r\n"
+                "Bob,01/02/2024,TRAN 04/01/24\r\n",
+                {"Alice,", "Bob,"}, {"\n\r"}, 3
+            },
+            {
+                // Sorting used to throw std::out_of_range when a row was too short to have the sort column
+                "short row without sort column",
+                "*InvoiceNumber,*Description,*DueDate,*ContactName\n"
+                "INV1,NF2F 03/01/24,01/02/2024,Carol\n"
+                "INV2\n"
+                "INV3,TRAN 04/01/24,01/02/2024,Alice\n",
+                {"INV2,", "Carol", "Alice"}, {}, 4
+            },
+        };
+    }
+}
+
+int main() {
+    std::mt19937 rng(20241018);
+    bool allPassed = true;
+
+    std::vector<GeneratedInput> generatedInputs = {
+        {
+            "typical 40 column export", [](std::mt19937 &rng, size_t) {
+                return pick(rng, {"x", "", "\"a, b\"", "12.50", "\"q \"\"quoted\"\"\""});
+            },
+            20000, 32, "\n", 0.0
+        },
+        {
+            "unbalanced quotes", [](std::mt19937 &rng, size_t) {
+                return pick(rng, {"x", "\"", "\"open, never closed", "a\"b", "\"\"\"", "close\","});
+            },
+            300, 6, "\n", 0.05
+        },
+        {
+            "embedded #!*", [](std::mt19937 &rng, size_t) {
+                return pick(rng, {"#!*", "\"#!*, #!*\"", "a#!*b", "\"x,#!*\"", "#!", "!*"});
+            },
+            500, 6, "\n", 0.05
+        },
+        {
+            "CRLF with blank lines", [](std::mt19937 &rng, size_t) {
+                return pick(rng, {"x", "\r", "\"line\r\nbreak\"", "\"a, b\"", ""});
+            },
+            500, 6, "\r\n\r\n", 0.05
+        },
+        {
+            "multi-line quoted records", [](std::mt19937 &rng, size_t) {
+                return pick(rng, {"x", "\"multi\nline, value\"", "\"\n\n\"", "\"a\nb\nc\""});
+            },
+            500, 6, "\n", 0.05
+        },
+        {
+            "huge fields", [](std::mt19937 &rng, size_t column) {
+                if (column == 0) {
+                    return "\"" + std::string(rng() % (1 << 20), 'x') + ", " + std::string(1000, '#') + "\"";
+                }
+                return pick(rng, {"x", std::string(65536, 'y')});
+            },
+            8, 3, "\n", 0.0
+        },
+        {
+            "short rows", [](std::mt19937 &rng, size_t) {
+                return pick(rng, {"x", "\"a, b\""});
+            },
+            500, 6, "\n", 0.5
+        },
+    };
+
+    for (const auto &input: generatedInputs) {
+        std::string csv = generate(input, rng);
+        ReadPathResult result = compareReadPaths(csv, LISHA_SETTINGS_FILE);
+        printReadPathResult(input.name, csv.size(), result);
+        allPassed = allPassed && result.match;
+    }
+
+    for (const auto &input: regressionInputs()) {
+        ReadPathResult result = compareReadPaths(input.csv, LISHA_SETTINGS_FILE);
+        printReadPathResult(input.name, input.csv.size(), result);
+        allPassed = allPassed && result.match;
+
+        const std::string &output = result.outputs[0];
+        for (const auto &expected: input.expectedInOutput) {
+            if (output.find(expected) == std::string::npos) {
+                std::cout << "  FAILED: expected '" << expected << "' in output" << std::endl;
+                allPassed = false;
+            }
+        }
+        for (const auto &notExpected: input.notExpectedInOutput) {
+            if (output.find(notExpected) != std::string::npos) {
+                std::cout << "  FAILED: did not expect '" << notExpected << "' in output" << std::endl;
+                allPassed = false;
+            }
+        }
+
+        size_t lines = std::count(output.begin(), output.end(), '\n');
+        if (lines != input.expectedLines) {
+            std::cout << "  FAILED: expected " << input.expectedLines << " lines, got " << lines << std::endl;
+            allPassed = false;
+        }
+    }
+
+    // Reading a second file with the same reader used to leave rows pointing into the first file's freed buffer
+    {
+        CSVReader reader;
+        reader.setSettingsFilePath(LISHA_SETTINGS_FILE);
+        reader.setProjectedColumns(reader.getReferencedColumns());
+
+        std::istringstream first("*ContactName,Notes\nAlice,first file notes which are not short\n");
+        std::istringstream second("*ContactName,Notes\nBob,second\n");
+        reader.readCsv(first);
+        reader.readCsv(second);
+
+        std::ostringstream output;
+        reader.writeCsv(output);
+        if (output.str() != "*ContactName,Notes\nBob,second\n") {
+            std::cout << "FAILED: second read on one reader gave '" << output.str() << "'" << std::endl;
+            allPassed = false;
+        }
+    }
+
+    // Timestamps outside what localtime can represent used to crash the (month) grouping
+    for (const std::string timeStamp: {"99999999999999999", "-99999999999999999", "999999999999999999999", "abc", "0"}) {
+        std::string month = CSVReader::timeStampToMonth(timeStamp);
+        if (month != "N/A") {
+            std::cout << "FAILED: expected N/A month for timestamp " << timeStamp << ", got " << month << std::endl;
+            allPassed = false;
+        }
+    }
+
+    std::cout << std::endl << (allPassed ? "All inputs passed" : "Some inputs FAILED") << std::endl;
+    return allPassed ? 0 : 1;
+}
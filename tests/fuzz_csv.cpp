@@ -0,0 +1,21 @@
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include "ReadPathCheck.h"
+
+/**
+ * libFuzzer target, runs the reference and projected read -> process -> write paths on the same bytes and aborts
+ * when they disagree so the input is kept as a crash
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    std::string csv(reinterpret_cast<const char *>(data), size);
+
+    ReadPathResult result = compareReadPaths(csv, LISHA_SETTINGS_FILE);
+    if (!result.match) {
+        printReadPathResult("fuzz input", size, result);
+        std::abort();
+    }
+
+    return 0;
+}